@@ -3,6 +3,136 @@
 #include <string>
 #include <stdexcept>
 #include <cmath>
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+#include <thread>
+#include <functional>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <map>
+#include <memory>
+#include <limits>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+// Счётчики горячих операций. Включаются флагом компиляции -DHW_PROFILING,
+// без него макросы HW_PROFILE_* ничего не генерируют.
+namespace ProfilingNamespace {
+
+    struct ProfileSite {
+        const char* site_name;
+        std::atomic<unsigned long long> call_count{ 0 };
+        std::atomic<unsigned long long> total_nanoseconds{ 0 };
+        std::atomic<unsigned long long> allocation_count{ 0 };
+        std::atomic<unsigned long long> allocated_bytes{ 0 };
+
+        explicit ProfileSite(const char* name);
+    };
+
+    struct ProfileRecord {
+        unsigned long long call_count = 0;
+        unsigned long long total_nanoseconds = 0;
+        unsigned long long allocation_count = 0;
+        unsigned long long allocated_bytes = 0;
+    };
+
+    inline std::mutex& site_mutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    inline std::vector<ProfileSite*>& site_list() {
+        static std::vector<ProfileSite*> sites;
+        return sites;
+    }
+
+    inline ProfileSite::ProfileSite(const char* name) : site_name(name) {
+        std::lock_guard<std::mutex> lock(site_mutex());
+        site_list().push_back(this);
+    }
+
+    // Одноимённые точки (например, из разных инстанциаций шаблона) суммируются
+    inline std::map<std::string, ProfileRecord> snapshot() {
+        std::lock_guard<std::mutex> lock(site_mutex());
+        std::map<std::string, ProfileRecord> records;
+        for (ProfileSite* site : site_list()) {
+            ProfileRecord& record = records[site->site_name];
+            record.call_count += site->call_count.load(std::memory_order_relaxed);
+            record.total_nanoseconds += site->total_nanoseconds.load(std::memory_order_relaxed);
+            record.allocation_count += site->allocation_count.load(std::memory_order_relaxed);
+            record.allocated_bytes += site->allocated_bytes.load(std::memory_order_relaxed);
+        }
+        return records;
+    }
+
+    inline void reset() {
+        std::lock_guard<std::mutex> lock(site_mutex());
+        for (ProfileSite* site : site_list()) {
+            site->call_count.store(0, std::memory_order_relaxed);
+            site->total_nanoseconds.store(0, std::memory_order_relaxed);
+            site->allocation_count.store(0, std::memory_order_relaxed);
+            site->allocated_bytes.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    class ScopedTimer {
+    private:
+        ProfileSite& profile_site;
+        std::chrono::steady_clock::time_point start_time;
+    public:
+        explicit ScopedTimer(ProfileSite& site) : profile_site(site), start_time(std::chrono::steady_clock::now()) {}
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        ~ScopedTimer() {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start_time).count();
+            profile_site.call_count.fetch_add(1, std::memory_order_relaxed);
+            profile_site.total_nanoseconds.fetch_add(static_cast<unsigned long long>(elapsed), std::memory_order_relaxed);
+        }
+    };
+
+#ifdef HW_PROFILING
+    const bool profiling_enabled = true;
+#else
+    const bool profiling_enabled = false;
+#endif
+
+}
+
+#define HW_PROFILE_CONCAT_IMPL(a, b) a##b
+#define HW_PROFILE_CONCAT(a, b) HW_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef HW_PROFILING
+#define HW_PROFILE_SCOPE(name) \
+    static ProfilingNamespace::ProfileSite HW_PROFILE_CONCAT(hw_profile_site_, __LINE__)(name); \
+    ProfilingNamespace::ScopedTimer HW_PROFILE_CONCAT(hw_profile_timer_, __LINE__)(HW_PROFILE_CONCAT(hw_profile_site_, __LINE__))
+#define HW_PROFILE_COUNT(name) \
+    do { \
+        static ProfilingNamespace::ProfileSite hw_profile_site(name); \
+        hw_profile_site.call_count.fetch_add(1, std::memory_order_relaxed); \
+    } while (0)
+#define HW_PROFILE_ALLOCATION(name, count, bytes) \
+    do { \
+        static ProfilingNamespace::ProfileSite hw_profile_site(name); \
+        hw_profile_site.allocation_count.fetch_add((count), std::memory_order_relaxed); \
+        hw_profile_site.allocated_bytes.fetch_add((bytes), std::memory_order_relaxed); \
+    } while (0)
+#else
+#define HW_PROFILE_SCOPE(name) ((void)0)
+#define HW_PROFILE_COUNT(name) ((void)0)
+#define HW_PROFILE_ALLOCATION(name, count, bytes) ((void)0)
+#endif
 
 template<typename T>
 struct Point {
@@ -30,11 +160,13 @@ protected:
 
 public:
     Polygon(const std::vector<Point<T>>& vertex_list) : vertices(vertex_list) {
+        HW_PROFILE_ALLOCATION("Polygon", 1, vertex_list.size() * sizeof(Point<T>));
         check_validity();
         instance_count++;
     }
 
     Polygon(const Polygon& other) : vertices(other.vertices) {
+        HW_PROFILE_ALLOCATION("Polygon", 1, other.vertices.size() * sizeof(Point<T>));
         instance_count++;
     }
 
@@ -72,6 +204,7 @@ public:
         : Polygon<T>({ vertex1, vertex2, vertex3 }) {}
 
     double area() const override {
+        HW_PROFILE_COUNT("Triangle::area");
         const auto& v = this->vertices;
         return std::abs((v[0].x * (v[1].y - v[2].y) +
             v[1].x * (v[2].y - v[0].y) +
@@ -111,6 +244,7 @@ public:
     }
 
     double area() const override {
+        HW_PROFILE_COUNT("Rectangle::area");
         const auto& v = this->vertices;
         auto width_value = std::sqrt((v[0].x - v[1].x) * (v[0].x - v[1].x) +
             (v[0].y - v[1].y) * (v[0].y - v[1].y));
@@ -149,7 +283,11 @@ namespace MatrixNamespace {
         int** matrix_data;
         static int matrix_count;
 
+        friend class MatrixTextIO;
+
         void allocate_matrix_memory() {
+            HW_PROFILE_ALLOCATION("Matrix", row_count + 1,
+                sizeof(int*) * row_count + sizeof(int) * static_cast<std::size_t>(row_count) * column_count);
             matrix_data = new int* [row_count];
             for (int i = 0; i < row_count; i++) {
                 matrix_data[i] = new int[column_count]();
@@ -221,6 +359,7 @@ namespace MatrixNamespace {
             if (row_count != other.row_count || column_count != other.column_count) {
                 throw MatrixException("Неверные размеры для сложения матриц");
             }
+            HW_PROFILE_SCOPE("Matrix::operator+");
             Matrix result_matrix(row_count, column_count);
             for (int i = 0; i < row_count; i++) {
                 for (int j = 0; j < column_count; j++) {
@@ -234,6 +373,7 @@ namespace MatrixNamespace {
             if (column_count != other.row_count) {
                 throw MatrixException("Неверные размеры для умножения матриц");
             }
+            HW_PROFILE_SCOPE("Matrix::operator*");
             Matrix result_matrix(row_count, other.column_count);
             for (int i = 0; i < row_count; i++) {
                 for (int j = 0; j < other.column_count; j++) {
@@ -250,6 +390,14 @@ namespace MatrixNamespace {
             return matrix_count;
         }
 
+        int get_row_count() const {
+            return row_count;
+        }
+
+        int get_column_count() const {
+            return column_count;
+        }
+
         class Iterator {
         private:
             Matrix& matrix_ref;
@@ -288,7 +436,7 @@ namespace MatrixNamespace {
                 for (int j = 0; j < matrix.column_count; j++) {
                     output << matrix.matrix_data[i][j] << " ";
                 }
-                output << std::endl;
+                output << '\n';
             }
             return output;
         }
@@ -296,6 +444,458 @@ namespace MatrixNamespace {
 
     int Matrix::matrix_count = 0;
 
+    // Пакет одинаковых матриц, элемент (i, j) всех матриц пакета лежит подряд:
+    // batch_data[(i * column_count + j) * batch_size + index]
+    class MatrixBatch {
+    private:
+        int row_count, column_count;
+        std::size_t batch_size;
+        std::vector<int> batch_data;
+
+    public:
+        MatrixBatch(std::size_t batch, int rows, int columns)
+            : row_count(rows), column_count(columns), batch_size(batch) {
+            if (batch_size == 0 || row_count <= 0 || column_count <= 0) {
+                throw MatrixException("Неверные размеры пакета матриц");
+            }
+            HW_PROFILE_ALLOCATION("MatrixBatch", 1, sizeof(int) * batch_size * row_count * column_count);
+            batch_data.assign(batch_size * row_count * column_count, 0);
+        }
+
+        int& operator()(std::size_t index, int row, int column) {
+            if (index >= batch_size || row < 0 || row >= row_count || column < 0 || column >= column_count) {
+                throw MatrixException("Выход за границы пакета матриц");
+            }
+            return batch_data[(static_cast<std::size_t>(row) * column_count + column) * batch_size + index];
+        }
+
+        const int& operator()(std::size_t index, int row, int column) const {
+            if (index >= batch_size || row < 0 || row >= row_count || column < 0 || column >= column_count) {
+                throw MatrixException("Выход за границы пакета матриц");
+            }
+            return batch_data[(static_cast<std::size_t>(row) * column_count + column) * batch_size + index];
+        }
+
+        int* lane(int row, int column) {
+            return batch_data.data() + (static_cast<std::size_t>(row) * column_count + column) * batch_size;
+        }
+
+        const int* lane(int row, int column) const {
+            return batch_data.data() + (static_cast<std::size_t>(row) * column_count + column) * batch_size;
+        }
+
+        void set_matrix(std::size_t index, const Matrix& matrix) {
+            if (matrix.get_row_count() != row_count || matrix.get_column_count() != column_count) {
+                throw MatrixException("Неверные размеры матрицы для пакета");
+            }
+            for (int i = 0; i < row_count; i++) {
+                for (int j = 0; j < column_count; j++) {
+                    (*this)(index, i, j) = matrix(i, j);
+                }
+            }
+        }
+
+        Matrix get_matrix(std::size_t index) const {
+            Matrix result_matrix(row_count, column_count);
+            for (int i = 0; i < row_count; i++) {
+                for (int j = 0; j < column_count; j++) {
+                    result_matrix(i, j) = (*this)(index, i, j);
+                }
+            }
+            return result_matrix;
+        }
+
+        std::size_t get_batch_size() const {
+            return batch_size;
+        }
+
+        int get_row_count() const {
+            return row_count;
+        }
+
+        int get_column_count() const {
+            return column_count;
+        }
+    };
+
+    namespace ParallelDetail {
+
+        // Выполняет task(chunk) для каждой части: часть 0 в текущем потоке, остальные в отдельных.
+        // Если поток создать не удалось, оставшиеся части выполняются здесь же.
+        // task не должен выбрасывать исключений.
+        template<typename Task>
+        inline void run_chunks(std::size_t chunk_count, const Task& task) {
+            std::vector<std::thread> workers;
+            std::size_t next_chunk = 1;
+            try {
+                workers.reserve(chunk_count);
+                for (; next_chunk < chunk_count; next_chunk++) {
+                    workers.emplace_back(task, next_chunk);
+                }
+            }
+            catch (...) {
+            }
+            task(0);
+            for (; next_chunk < chunk_count; next_chunk++) {
+                task(next_chunk);
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+    }
+
+    namespace BatchDetail {
+
+        // Пакеты меньше этого размера умножаются в одном потоке
+        const std::size_t parallel_threshold = 4096;
+        // Блок матриц, для которого все используемые полосы помещаются в L1.
+        // Части, отдаваемые потокам, кратны размеру блока.
+        const std::size_t block_size = 256;
+
+        // Умножает матрицы [offset, offset + length) пакета, length <= block_size.
+        // Сумма копится в локальном буфере, каждая полоса результата пишется один раз.
+        // Для полного блока длина известна при компиляции, и цикл векторизуется уже на -O2
+        template<bool full_block>
+        inline void multiply_block(const MatrixBatch& left, const MatrixBatch& right, MatrixBatch& result,
+            std::size_t offset, std::size_t length) noexcept {
+            const std::size_t count = full_block ? block_size : length;
+            int accumulator[block_size];
+            const int inner_count = left.get_column_count();
+            for (int i = 0; i < result.get_row_count(); i++) {
+                for (int j = 0; j < result.get_column_count(); j++) {
+                    for (std::size_t index = 0; index < count; index++) {
+                        accumulator[index] = 0;
+                    }
+                    for (int k = 0; k < inner_count; k++) {
+                        const int* left_lane = left.lane(i, k) + offset;
+                        const int* right_lane = right.lane(k, j) + offset;
+                        for (std::size_t index = 0; index < count; index++) {
+                            accumulator[index] += left_lane[index] * right_lane[index];
+                        }
+                    }
+                    std::copy_n(accumulator, count, result.lane(i, j) + offset);
+                }
+            }
+        }
+
+        inline void multiply_batch_range(const MatrixBatch& left, const MatrixBatch& right, MatrixBatch& result,
+            std::size_t begin, std::size_t end) noexcept {
+            std::size_t offset = begin;
+            for (; offset + block_size <= end; offset += block_size) {
+                multiply_block<true>(left, right, result, offset, block_size);
+            }
+            if (offset < end) {
+                multiply_block<false>(left, right, result, offset, end - offset);
+            }
+        }
+
+    }
+
+    inline void multiply_batch(const MatrixBatch& left, const MatrixBatch& right, MatrixBatch& result,
+        unsigned thread_count = 0) {
+        if (left.get_batch_size() != right.get_batch_size() || left.get_batch_size() != result.get_batch_size()) {
+            throw MatrixException("Неверные размеры пакетов для умножения");
+        }
+        if (left.get_column_count() != right.get_row_count() ||
+            result.get_row_count() != left.get_row_count() || result.get_column_count() != right.get_column_count()) {
+            throw MatrixException("Неверные размеры для умножения матриц");
+        }
+
+        if (&result == &left || &result == &right) {
+            throw MatrixException("Результат пакетного умножения не может совпадать с множителем");
+        }
+
+        HW_PROFILE_SCOPE("multiply_batch");
+        const std::size_t batch_size = left.get_batch_size();
+        if (thread_count == 0) {
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+        if (batch_size < BatchDetail::parallel_threshold) {
+            thread_count = 1;
+        }
+        if (thread_count == 1) {
+            BatchDetail::multiply_batch_range(left, right, result, 0, batch_size);
+            return;
+        }
+
+        std::size_t chunk_size = (batch_size + thread_count - 1) / thread_count;
+        chunk_size = (chunk_size + BatchDetail::block_size - 1) / BatchDetail::block_size * BatchDetail::block_size;
+
+        const std::size_t chunk_count = (batch_size + chunk_size - 1) / chunk_size;
+        ParallelDetail::run_chunks(chunk_count, [&](std::size_t chunk) {
+            const std::size_t begin = chunk * chunk_size;
+            BatchDetail::multiply_batch_range(left, right, result, begin, std::min(batch_size, begin + chunk_size));
+        });
+    }
+
+    inline MatrixBatch operator*(const MatrixBatch& left, const MatrixBatch& right) {
+        MatrixBatch result_batch(left.get_batch_size(), left.get_row_count(), right.get_column_count());
+        multiply_batch(left, right, result_batch);
+        return result_batch;
+    }
+
+    // Текстовый формат: заголовок "rows columns", затем по строке на каждую
+    // строку матрицы, числа разделены пробелами. Пустые строки пропускаются
+    // везде, в том числе перед заголовком.
+    class MatrixTextIO {
+    private:
+        static const std::size_t buffer_size = 1 << 20;
+        // Части меньше этого размера не делятся между потоками
+        static const std::size_t min_chunk_size = 1 << 20;
+
+        struct ChunkResult {
+            std::size_t line_count = 0;
+            std::size_t row_count = 0;
+            std::size_t error_line = 0;
+            std::string error_message;
+        };
+
+        static bool is_blank(char symbol) {
+            return symbol == ' ' || symbol == '\t' || symbol == '\r';
+        }
+
+        static bool is_blank_line(const char* line_begin, const char* line_end) {
+            return std::find_if_not(line_begin, line_end, is_blank) == line_end;
+        }
+
+        static std::string line_error(std::size_t line, const std::string& message) {
+            return "Строка " + std::to_string(line) + ": " + message;
+        }
+
+        // Разбирает строку в row (не больше column_count чисел),
+        // возвращает количество чисел в строке или -1 при ошибке
+        static long parse_line(const char* position, const char* line_end, int* row, int column_count,
+            std::string& error_message) {
+            long value_count = 0;
+            while (true) {
+                while (position != line_end && is_blank(*position)) {
+                    position++;
+                }
+                if (position == line_end) {
+                    return value_count;
+                }
+                int value;
+                auto [next, error] = std::from_chars(position, line_end, value);
+                if (error == std::errc::result_out_of_range) {
+                    error_message = "число вне диапазона int";
+                    return -1;
+                }
+                if (error != std::errc() || (next != line_end && !is_blank(*next))) {
+                    error_message = "неверное число";
+                    return -1;
+                }
+                if (value_count < column_count) {
+                    row[value_count] = value;
+                }
+                value_count++;
+                position = next;
+            }
+        }
+
+        static const char* line_end_of(const char* position, const char* end) {
+            const char* found = static_cast<const char*>(std::memchr(position, '\n', end - position));
+            return found ? found : end;
+        }
+
+        // Первый проход: число строк файла и непустых строк матрицы в части
+        static void count_chunk(const char* begin, const char* end, ChunkResult& result) noexcept {
+            for (const char* line_begin = begin; line_begin < end; ) {
+                const char* line_end = line_end_of(line_begin, end);
+                result.line_count++;
+                if (!is_blank_line(line_begin, line_end)) {
+                    result.row_count++;
+                }
+                line_begin = line_end + 1;
+            }
+        }
+
+        // Второй проход: разбор части прямо в строки матрицы начиная с first_row
+        static void parse_chunk(const char* begin, const char* end, Matrix& matrix, std::size_t first_row,
+            ChunkResult& result) noexcept {
+            try {
+                std::size_t line = 0, row = first_row;
+                for (const char* line_begin = begin; line_begin < end; ) {
+                    const char* line_end = line_end_of(line_begin, end);
+                    line++;
+                    if (!is_blank_line(line_begin, line_end)) {
+                        if (row >= static_cast<std::size_t>(matrix.row_count)) {
+                            result.error_line = line;
+                            result.error_message = "лишняя строка, ожидалось " + std::to_string(matrix.row_count) + " строк";
+                            return;
+                        }
+                        long value_count = parse_line(line_begin, line_end, matrix.matrix_data[row], matrix.column_count,
+                            result.error_message);
+                        if (value_count < 0) {
+                            result.error_line = line;
+                            return;
+                        }
+                        if (value_count != matrix.column_count) {
+                            result.error_line = line;
+                            result.error_message = "ожидалось " + std::to_string(matrix.column_count) +
+                                " чисел, получено " + std::to_string(value_count);
+                            return;
+                        }
+                        row++;
+                    }
+                    line_begin = line_end + 1;
+                }
+            }
+            catch (const std::exception& e) {
+                result.error_line = 0;
+                result.error_message = e.what();
+            }
+        }
+
+    public:
+        static void write(std::ostream& output, const Matrix& matrix) {
+            HW_PROFILE_SCOPE("MatrixTextIO::write");
+            std::vector<char> buffer(buffer_size);
+            char* const buffer_end = buffer.data() + buffer.size();
+            char* position = buffer.data();
+            // Запас на одно число int и разделитель
+            const std::ptrdiff_t reserve = 16;
+
+            auto flush = [&]() {
+                output.write(buffer.data(), position - buffer.data());
+                position = buffer.data();
+            };
+            auto put = [&](int value, char separator) {
+                if (buffer_end - position < reserve) {
+                    flush();
+                }
+                auto [next, error] = std::to_chars(position, buffer_end, value);
+                if (error == std::errc()) {
+                    position = next;
+                    *position++ = separator;
+                }
+            };
+
+            put(matrix.row_count, ' ');
+            put(matrix.column_count, '\n');
+            for (int i = 0; i < matrix.row_count; i++) {
+                const int* row = matrix.matrix_data[i];
+                for (int j = 0; j + 1 < matrix.column_count; j++) {
+                    put(row[j], ' ');
+                }
+                put(row[matrix.column_count - 1], '\n');
+            }
+            flush();
+            if (!output) {
+                throw MatrixException("Ошибка записи матрицы");
+            }
+        }
+
+        static void write_file(const std::string& path, const Matrix& matrix) {
+            std::ofstream output(path, std::ios::binary);
+            if (!output) {
+                throw MatrixException("Не удалось открыть файл " + path);
+            }
+            write(output, matrix);
+        }
+
+        static Matrix parse(const char* data, std::size_t size, unsigned thread_count = 0) {
+            HW_PROFILE_SCOPE("MatrixTextIO::parse");
+            const char* const end = data + size;
+            const char* header_begin = data;
+            const char* header_end = line_end_of(header_begin, end);
+            std::size_t header_line = 1;
+            while (header_end != end && is_blank_line(header_begin, header_end)) {
+                header_begin = header_end + 1;
+                header_end = line_end_of(header_begin, end);
+                header_line++;
+            }
+
+            int header[2];
+            std::string error_message;
+            if (parse_line(header_begin, header_end, header, 2, error_message) != 2 || header[0] <= 0 || header[1] <= 0) {
+                throw MatrixException(line_error(header_line, "ожидался заголовок \"строки столбцы\""));
+            }
+            const int row_count = header[0], column_count = header[1];
+            const char* const body = header_end == end ? end : header_end + 1;
+            const std::size_t body_size = end - body;
+            // Каждое число занимает хотя бы символ и разделитель, так что заголовок,
+            // не помещающийся в файл, отвергается до выделения памяти под матрицу
+            if (static_cast<std::size_t>(column_count) > body_size / 2 + 1) {
+                throw MatrixException(line_error(header_line, "столбцов " + std::to_string(column_count) +
+                    " больше, чем помещается в данных"));
+            }
+
+            if (thread_count == 0) {
+                thread_count = std::max(1u, std::thread::hardware_concurrency());
+            }
+            std::size_t chunk_count = std::min<std::size_t>(thread_count, body_size / min_chunk_size + 1);
+
+            std::vector<const char*> boundaries{ body };
+            for (std::size_t chunk = 1; chunk < chunk_count; chunk++) {
+                const char* target = std::max(boundaries.back(), body + body_size * chunk / chunk_count);
+                const char* boundary = line_end_of(target, end);
+                boundaries.push_back(boundary == end ? end : boundary + 1);
+            }
+            boundaries.push_back(end);
+            chunk_count = boundaries.size() - 1;
+
+            std::vector<ChunkResult> results(chunk_count);
+            ParallelDetail::run_chunks(chunk_count, [&](std::size_t chunk) {
+                count_chunk(boundaries[chunk], boundaries[chunk + 1], results[chunk]);
+            });
+
+            std::vector<std::size_t> first_rows(chunk_count);
+            std::size_t rows_read = 0, end_line = header_line + 1;
+            for (std::size_t chunk = 0; chunk < chunk_count; chunk++) {
+                first_rows[chunk] = rows_read;
+                rows_read += results[chunk].row_count;
+                end_line += results[chunk].line_count;
+            }
+            if (rows_read < static_cast<std::size_t>(row_count)) {
+                throw MatrixException(line_error(end_line, "ожидалось " + std::to_string(row_count) +
+                    " строк, получено " + std::to_string(rows_read)));
+            }
+            if (static_cast<std::size_t>(row_count) * (2 * static_cast<std::size_t>(column_count) - 1) > body_size) {
+                throw MatrixException(line_error(header_line, "матрица " + std::to_string(row_count) + "x" +
+                    std::to_string(column_count) + " больше, чем помещается в данных"));
+            }
+
+            Matrix result_matrix(row_count, column_count);
+            ParallelDetail::run_chunks(chunk_count, [&](std::size_t chunk) {
+                parse_chunk(boundaries[chunk], boundaries[chunk + 1], result_matrix, first_rows[chunk], results[chunk]);
+            });
+
+            std::size_t first_line = header_line + 1;
+            for (const ChunkResult& result : results) {
+                if (!result.error_message.empty()) {
+                    if (result.error_line == 0) {
+                        throw MatrixException("Ошибка разбора матрицы: " + result.error_message);
+                    }
+                    throw MatrixException(line_error(first_line + result.error_line - 1, result.error_message));
+                }
+                first_line += result.line_count;
+            }
+            return result_matrix;
+        }
+
+        static Matrix read(std::istream& input, unsigned thread_count = 0) {
+            std::ostringstream buffer;
+            buffer << input.rdbuf();
+            const std::string text = buffer.str();
+            return parse(text.data(), text.size(), thread_count);
+        }
+
+        static Matrix read_file(const std::string& path, unsigned thread_count = 0) {
+            std::ifstream input(path, std::ios::binary | std::ios::ate);
+            if (!input) {
+                throw MatrixException("Не удалось открыть файл " + path);
+            }
+            std::string text(static_cast<std::size_t>(input.tellg()), '\0');
+            input.seekg(0);
+            if (!input.read(text.data(), text.size())) {
+                throw MatrixException("Ошибка чтения файла " + path);
+            }
+            return parse(text.data(), text.size(), thread_count);
+        }
+    };
+
 }
 
 class Person {
@@ -336,6 +936,7 @@ public:
 };
 
 bool compare_by_age(const Person& person1, const Person& person2) {
+    HW_PROFILE_COUNT("compare_by_age");
     return person1.person_age < person2.person_age;
 }
 
@@ -433,12 +1034,14 @@ namespace SmartPointerNamespace {
         }
 
         SmartPointer(const SmartPointer& other) : pointer(other.pointer) {
+            HW_PROFILE_COUNT("SmartPointer::copy");
             if (pointer) {
                 reference_count++;
             }
         }
 
         SmartPointer& operator=(const SmartPointer& other) {
+            HW_PROFILE_COUNT("SmartPointer::assign");
             if (this != &other) {
                 if (pointer) {
                     reference_count--;
@@ -455,6 +1058,7 @@ namespace SmartPointerNamespace {
         }
 
         ~SmartPointer() {
+            HW_PROFILE_COUNT("SmartPointer::destroy");
             if (pointer) {
                 reference_count--;
                 if (reference_count == 0) {
@@ -512,12 +1116,14 @@ namespace SmartPointerNamespace {
             }
         }
         SmartPointer(const SmartPointer& other) : pointer(other.pointer) {
+            HW_PROFILE_COUNT("SmartPointer::copy");
             if (pointer) {
                 reference_count++;
             }
         }
 
         SmartPointer& operator=(const SmartPointer& other) {
+            HW_PROFILE_COUNT("SmartPointer::assign");
             if (this != &other) {
                 if (pointer) {
                     reference_count--;
@@ -534,6 +1140,7 @@ namespace SmartPointerNamespace {
         }
 
         ~SmartPointer() {
+            HW_PROFILE_COUNT("SmartPointer::destroy");
             if (pointer) {
                 reference_count--;
                 if (reference_count == 0) {
@@ -584,8 +1191,464 @@ namespace SmartPointerNamespace {
 
 }
 
-int main() {
+namespace BenchmarkNamespace {
+
+    using namespace MatrixNamespace;
+    using namespace SmartPointerNamespace;
+
+    // Подготовленный замер: body выполняется многократно, подготовка данных в замер не входит.
+    // Ресурсы замера (например, временные файлы) живут в захвате body и освобождаются вместе с ним.
+    struct BenchmarkRun {
+        std::function<void()> body;
+        std::size_t bytes_processed;
+
+        BenchmarkRun(std::function<void()> run_body, std::size_t bytes = 0)
+            : body(std::move(run_body)), bytes_processed(bytes) {}
+    };
+
+    struct BenchmarkCase {
+        std::string name;
+        std::vector<std::size_t> parameters;
+        std::function<BenchmarkRun(std::size_t)> prepare;
+    };
+
+    struct BenchmarkResult {
+        std::string name;
+        std::size_t parameter;
+        std::size_t bytes_processed;
+        std::vector<double> samples;
+        std::map<std::string, ProfilingNamespace::ProfileRecord> profile;
+    };
+
+    struct BenchmarkOptions {
+        int repetitions = 5;
+        std::string filter;
+        std::string json_path;
+        std::size_t text_megabytes = 64;
+    };
+
+    // Не даёт компилятору выбросить результат замеряемого кода
+    inline volatile long long benchmark_sink = 0;
+
+    inline double elapsed_milliseconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    inline Matrix make_matrix(int rows, int columns, int seed) {
+        Matrix matrix(rows, columns);
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < columns; j++) {
+                matrix(i, j) = (i * 7919 + j * 104729 + seed * 31) % 201 - 100;
+            }
+        }
+        return matrix;
+    }
+
+    inline BenchmarkRun prepare_matrix_add(std::size_t size) {
+        const int dimension = static_cast<int>(size);
+        auto left = std::make_shared<Matrix>(make_matrix(dimension, dimension, 1));
+        auto right = std::make_shared<Matrix>(make_matrix(dimension, dimension, 2));
+        return { [left, right, dimension]() {
+            Matrix sum_matrix = *left + *right;
+            benchmark_sink = benchmark_sink + sum_matrix(dimension - 1, dimension - 1);
+        } };
+    }
+
+    inline BenchmarkRun prepare_matrix_multiply(std::size_t size) {
+        const int dimension = static_cast<int>(size);
+        auto left = std::make_shared<Matrix>(make_matrix(dimension, dimension, 1));
+        auto right = std::make_shared<Matrix>(make_matrix(dimension, dimension, 2));
+        return { [left, right, dimension]() {
+            Matrix product_matrix = *left * *right;
+            benchmark_sink = benchmark_sink + product_matrix(dimension - 1, dimension - 1);
+        } };
+    }
+
+    const std::size_t small_matrix_count = 1 << 18;
+
+    struct SmallMatrixData {
+        std::vector<Matrix> left_matrices, right_matrices;
+        MatrixBatch left_batch, right_batch, result_batch;
+
+        explicit SmallMatrixData(int dimension)
+            : left_batch(small_matrix_count, dimension, dimension),
+            right_batch(small_matrix_count, dimension, dimension),
+            result_batch(small_matrix_count, dimension, dimension) {
+            left_matrices.reserve(small_matrix_count);
+            right_matrices.reserve(small_matrix_count);
+            for (std::size_t index = 0; index < small_matrix_count; index++) {
+                left_matrices.push_back(make_matrix(dimension, dimension, static_cast<int>(index)));
+                right_matrices.push_back(make_matrix(dimension, dimension, static_cast<int>(index) + 7));
+                left_batch.set_matrix(index, left_matrices.back());
+                right_batch.set_matrix(index, right_matrices.back());
+            }
+        }
+    };
+
+    inline BenchmarkRun prepare_small_multiply_loop(std::size_t size) {
+        auto data = std::make_shared<SmallMatrixData>(static_cast<int>(size));
+        return { [data]() {
+            long long checksum = 0;
+            for (std::size_t index = 0; index < small_matrix_count; index++) {
+                checksum += (data->left_matrices[index] * data->right_matrices[index])(0, 0);
+            }
+            benchmark_sink = benchmark_sink + checksum;
+        } };
+    }
+
+    inline BenchmarkRun prepare_small_multiply_batch(std::size_t size, unsigned thread_count) {
+        auto data = std::make_shared<SmallMatrixData>(static_cast<int>(size));
+        multiply_batch(data->left_batch, data->right_batch, data->result_batch, thread_count);
+        for (std::size_t index = 0; index < small_matrix_count; index += 4099) {
+            Matrix expected = data->left_matrices[index] * data->right_matrices[index];
+            for (int i = 0; i < expected.get_row_count(); i++) {
+                for (int j = 0; j < expected.get_column_count(); j++) {
+                    if (expected(i, j) != data->result_batch(index, i, j)) {
+                        throw MatrixException("Результат multiply_batch не совпадает с operator*");
+                    }
+                }
+            }
+        }
+        return { [data, thread_count]() {
+            multiply_batch(data->left_batch, data->right_batch, data->result_batch, thread_count);
+            benchmark_sink = benchmark_sink + data->result_batch(0, 0, 0);
+        } };
+    }
+
+    // Временный файл с уникальным для процесса именем, удаляется в деструкторе
+    class TemporaryFile {
+    private:
+        std::string file_path;
+    public:
+        explicit TemporaryFile(const std::string& name) {
+#ifdef _WIN32
+            const int process_id = _getpid();
+#else
+            const int process_id = static_cast<int>(getpid());
+#endif
+            file_path = (std::filesystem::temp_directory_path() /
+                ("hw031125_" + std::to_string(process_id) + "_" + name)).string();
+        }
+
+        TemporaryFile(const TemporaryFile&) = delete;
+        TemporaryFile& operator=(const TemporaryFile&) = delete;
+
+        ~TemporaryFile() {
+            std::error_code error;
+            std::filesystem::remove(file_path, error);
+        }
+
+        const std::string& path() const {
+            return file_path;
+        }
+    };
+
+    const int text_column_count = 1000;
+    // Около 7 байт на число: знак, до 5 цифр и разделитель
+    const long long text_bytes_per_row = text_column_count * 7LL;
+    // Наибольший размер, при котором число строк ещё помещается в int
+    const long long max_text_megabytes = std::numeric_limits<int>::max() * text_bytes_per_row / (1 << 20);
+
+    inline Matrix make_text_matrix(std::size_t megabytes) {
+        const int column_count = text_column_count;
+        const int row_count = static_cast<int>(std::max<long long>(1,
+            static_cast<long long>(megabytes) * (1 << 20) / text_bytes_per_row));
+        Matrix matrix(row_count, column_count);
+        for (int i = 0; i < row_count; i++) {
+            for (int j = 0; j < column_count; j++) {
+                matrix(i, j) = static_cast<int>((i * 7919LL + j * 104729LL) % 200001) - 100000;
+            }
+        }
+        return matrix;
+    }
+
+    inline BenchmarkRun prepare_text_write(std::size_t megabytes) {
+        auto matrix = std::make_shared<Matrix>(make_text_matrix(megabytes));
+        auto file = std::make_shared<TemporaryFile>("text_write.txt");
+        MatrixTextIO::write_file(file->path(), *matrix);
+        const std::size_t bytes = static_cast<std::size_t>(std::filesystem::file_size(file->path()));
+        return { [matrix, file]() { MatrixTextIO::write_file(file->path(), *matrix); }, bytes };
+    }
+
+    inline BenchmarkRun prepare_text_read(std::size_t megabytes) {
+        auto file = std::make_shared<TemporaryFile>("text_read.txt");
+        {
+            Matrix matrix = make_text_matrix(megabytes);
+            MatrixTextIO::write_file(file->path(), matrix);
+            Matrix read_matrix = MatrixTextIO::read_file(file->path());
+            for (int i = 0; i < matrix.get_row_count(); i++) {
+                for (int j = 0; j < matrix.get_column_count(); j++) {
+                    if (matrix(i, j) != read_matrix(i, j)) {
+                        throw MatrixException("Прочитанная матрица не совпадает с записанной");
+                    }
+                }
+            }
+        }
+        const std::size_t bytes = static_cast<std::size_t>(std::filesystem::file_size(file->path()));
+        return { [file]() {
+            Matrix read_matrix = MatrixTextIO::read_file(file->path());
+            benchmark_sink = benchmark_sink + read_matrix(0, 0);
+        }, bytes };
+    }
+
+    inline BenchmarkRun prepare_shape_construct(std::size_t count) {
+        return { [count]() {
+            long long checksum = 0;
+            for (std::size_t index = 0; index < count; index++) {
+                const double offset = static_cast<double>(index % 100);
+                Triangle<double> triangle(Point<double>(offset, 0), Point<double>(offset + 2, 0), Point<double>(offset, 3));
+                Rectangle<double> rectangle(Point<double>(0, 0), Point<double>(offset + 1, 0),
+                    Point<double>(offset + 1, 2), Point<double>(0, 2));
+                checksum += Polygon<double>::get_instance_count();
+            }
+            benchmark_sink = benchmark_sink + checksum;
+        } };
+    }
+
+    inline BenchmarkRun prepare_shape_area(std::size_t count) {
+        auto shapes = std::make_shared<std::vector<std::unique_ptr<Shape>>>();
+        shapes->reserve(count);
+        for (std::size_t index = 0; index < count; index++) {
+            const double offset = static_cast<double>(index % 100);
+            if (index % 2 == 0) {
+                shapes->push_back(std::make_unique<Triangle<double>>(
+                    Point<double>(offset, 0), Point<double>(offset + 2, 0), Point<double>(offset, 3)));
+            }
+            else {
+                shapes->push_back(std::make_unique<Rectangle<double>>(Point<double>(0, 0), Point<double>(offset + 1, 0),
+                    Point<double>(offset + 1, 2), Point<double>(0, 2)));
+            }
+        }
+        return { [shapes]() {
+            double total_area = 0;
+            for (const auto& shape : *shapes) {
+                total_area += shape->area();
+            }
+            benchmark_sink = benchmark_sink + static_cast<long long>(total_area);
+        } };
+    }
+
+    inline BenchmarkRun prepare_smart_pointer_churn(std::size_t count) {
+        return { [count]() {
+            SmartPointer<int> source(new int(42));
+            std::vector<SmartPointer<int>> copies;
+            copies.reserve(count);
+            for (std::size_t index = 0; index < count; index++) {
+                copies.push_back(source);
+            }
+            for (std::size_t index = 1; index < count; index += 2) {
+                copies[index] = copies[index - 1];
+            }
+            benchmark_sink = benchmark_sink + SmartPointer<int>::get_reference_count();
+        } };
+    }
+
+    inline std::vector<Person> make_persons(std::size_t count) {
+        std::vector<Person> persons;
+        persons.reserve(count);
+        for (std::size_t index = 0; index < count; index++) {
+            persons.emplace_back("Person" + std::to_string(index), static_cast<int>((index * 37) % 151));
+        }
+        return persons;
+    }
+
+    inline BenchmarkRun prepare_person_sort(std::size_t count) {
+        auto persons = std::make_shared<std::vector<Person>>(make_persons(count));
+        // Сортируется копия, чтобы каждый повтор получал одинаковый вход
+        return { [persons]() {
+            std::vector<Person> sorted_persons = *persons;
+            std::sort(sorted_persons.begin(), sorted_persons.end(), compare_by_age);
+            benchmark_sink = benchmark_sink + sorted_persons.back().get_person_age();
+        } };
+    }
+
+    inline BenchmarkRun prepare_person_scan(std::size_t count) {
+        auto persons = std::make_shared<std::vector<Person>>(make_persons(count));
+        return { [persons]() {
+            long long age_sum = 0;
+            std::size_t name_matches = 0;
+            for (const Person& person : *persons) {
+                age_sum += person.get_person_age();
+                if (person.get_person_name().back() == '7') {
+                    name_matches++;
+                }
+            }
+            benchmark_sink = benchmark_sink + age_sum + static_cast<long long>(name_matches);
+        } };
+    }
+
+    inline std::vector<BenchmarkCase> make_benchmark_cases(const BenchmarkOptions& options) {
+        return {
+            { "matrix_add", { 64, 256, 1024 }, prepare_matrix_add },
+            { "matrix_multiply", { 16, 64, 256 }, prepare_matrix_multiply },
+            { "small_matrix_multiply_loop", { 3, 4 }, prepare_small_multiply_loop },
+            { "small_matrix_multiply_batch_1_thread", { 3, 4 },
+                [](std::size_t size) { return prepare_small_multiply_batch(size, 1); } },
+            { "small_matrix_multiply_batch", { 3, 4 },
+                [](std::size_t size) { return prepare_small_multiply_batch(size, 0); } },
+            { "matrix_text_write_mb", { options.text_megabytes }, prepare_text_write },
+            { "matrix_text_read_mb", { options.text_megabytes }, prepare_text_read },
+            { "shape_construct", { 1000, 100000 }, prepare_shape_construct },
+            { "shape_area", { 1000, 100000 }, prepare_shape_area },
+            { "smart_pointer_churn", { 1000, 100000 }, prepare_smart_pointer_churn },
+            { "person_sort", { 1000, 100000 }, prepare_person_sort },
+            { "person_scan", { 1000, 100000 }, prepare_person_scan },
+        };
+    }
+
+    inline BenchmarkResult run_benchmark(const BenchmarkCase& benchmark, std::size_t parameter, int repetitions) {
+        BenchmarkRun run = benchmark.prepare(parameter);
+        BenchmarkResult result{ benchmark.name, parameter, run.bytes_processed, {}, {} };
+
+        run.body();
+        ProfilingNamespace::reset();
+        for (int repetition = 0; repetition < repetitions; repetition++) {
+            auto start = std::chrono::steady_clock::now();
+            run.body();
+            result.samples.push_back(elapsed_milliseconds(start));
+        }
+        for (const auto& [site_name, record] : ProfilingNamespace::snapshot()) {
+            if (record.call_count != 0 || record.allocation_count != 0) {
+                result.profile.emplace(site_name, record);
+            }
+        }
+        return result;
+    }
+
+    inline double median(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        const std::size_t middle = values.size() / 2;
+        return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+    }
+
+    inline double mean(const std::vector<double>& values) {
+        double sum = 0;
+        for (double value : values) {
+            sum += value;
+        }
+        return sum / values.size();
+    }
+
+    inline double megabytes_per_second(const BenchmarkResult& result) {
+        return result.bytes_processed / double(1 << 20) / (median(result.samples) / 1000);
+    }
+
+    inline void write_json_report(std::ostream& output, const BenchmarkOptions& options,
+        const std::vector<BenchmarkResult>& results) {
+        output << "{\n  \"repetitions\": " << options.repetitions
+            << ",\n  \"profiling\": " << (ProfilingNamespace::profiling_enabled ? "true" : "false")
+            << ",\n  \"benchmarks\": [";
+        for (std::size_t index = 0; index < results.size(); index++) {
+            const BenchmarkResult& result = results[index];
+            output << (index ? "," : "") << "\n    {\n"
+                << "      \"name\": \"" << result.name << "\",\n"
+                << "      \"parameter\": " << result.parameter << ",\n"
+                << "      \"min_ms\": " << *std::min_element(result.samples.begin(), result.samples.end()) << ",\n"
+                << "      \"median_ms\": " << median(result.samples) << ",\n"
+                << "      \"mean_ms\": " << mean(result.samples) << ",\n";
+            if (result.bytes_processed != 0) {
+                output << "      \"bytes\": " << result.bytes_processed << ",\n"
+                    << "      \"megabytes_per_second\": " << megabytes_per_second(result) << ",\n";
+            }
+            output << "      \"samples_ms\": [";
+            for (std::size_t sample = 0; sample < result.samples.size(); sample++) {
+                output << (sample ? ", " : "") << result.samples[sample];
+            }
+            output << "],\n      \"profile\": {";
+            bool first_site = true;
+            for (const auto& [site_name, record] : result.profile) {
+                output << (first_site ? "" : ",") << "\n        \"" << site_name << "\": { \"calls\": " << record.call_count
+                    << ", \"total_ms\": " << record.total_nanoseconds / 1e6
+                    << ", \"allocations\": " << record.allocation_count
+                    << ", \"allocated_bytes\": " << record.allocated_bytes << " }";
+                first_site = false;
+            }
+            output << (first_site ? "}" : "\n      }") << "\n    }";
+        }
+        output << "\n  ]\n}\n";
+    }
+
+    inline BenchmarkOptions parse_benchmark_options(int argc, char* argv[]) {
+        BenchmarkOptions options;
+        for (int index = 2; index < argc; index++) {
+            const std::string option = argv[index];
+            if (index + 1 >= argc) {
+                throw std::invalid_argument("Не задано значение параметра " + option);
+            }
+            const std::string value = argv[++index];
+            if (option == "--repeat") {
+                options.repetitions = std::stoi(value);
+                if (options.repetitions <= 0) {
+                    throw std::invalid_argument("Число повторов должно быть положительным");
+                }
+            }
+            else if (option == "--filter") {
+                options.filter = value;
+            }
+            else if (option == "--json") {
+                options.json_path = value;
+            }
+            else if (option == "--text-mb") {
+                const long long megabytes = std::stoll(value);
+                if (megabytes <= 0 || megabytes > max_text_megabytes) {
+                    throw std::invalid_argument("Размер файла должен быть от 1 до " +
+                        std::to_string(max_text_megabytes) + " МБ");
+                }
+                options.text_megabytes = static_cast<std::size_t>(megabytes);
+            }
+            else {
+                throw std::invalid_argument("Неизвестный параметр " + option);
+            }
+        }
+        return options;
+    }
+
+    inline int run_benchmarks(int argc, char* argv[]) {
+        const BenchmarkOptions options = parse_benchmark_options(argc, argv);
+        std::vector<BenchmarkResult> results;
+
+        std::cout << "Тест / параметр: минимум, медиана, среднее (мс) за " << options.repetitions << " повторов" << std::endl;
+        for (const BenchmarkCase& benchmark : make_benchmark_cases(options)) {
+            if (benchmark.name.find(options.filter) == std::string::npos) {
+                continue;
+            }
+            for (std::size_t parameter : benchmark.parameters) {
+                BenchmarkResult result = run_benchmark(benchmark, parameter, options.repetitions);
+                std::cout << result.name << " / " << result.parameter << ": "
+                    << *std::min_element(result.samples.begin(), result.samples.end()) << ", "
+                    << median(result.samples) << ", " << mean(result.samples);
+                if (result.bytes_processed != 0) {
+                    std::cout << " (" << megabytes_per_second(result) << " МБ/с)";
+                }
+                std::cout << std::endl;
+                results.push_back(std::move(result));
+            }
+        }
+
+        if (!options.json_path.empty()) {
+            std::ofstream report(options.json_path);
+            if (!report) {
+                throw std::runtime_error("Не удалось открыть файл " + options.json_path);
+            }
+            write_json_report(report, options, results);
+        }
+        return 0;
+    }
+
+}
+
+int main(int argc, char* argv[]) {
     setlocale(LC_ALL, "RUS");
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        try {
+            return BenchmarkNamespace::run_benchmarks(argc, argv);
+        }
+        catch (const std::exception& e) {
+            std::cout << "Ошибка: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
     std::cout << "Задание 1" << std::endl;
     try {
         try {
@@ -635,6 +1698,32 @@ int main() {
         std::cout << std::endl;
 
         std::cout << "Матриц : " << Matrix::get_matrix_count() << std::endl;
+
+        MatrixBatch left_batch(3, 2, 2), right_batch(3, 2, 2);
+        for (std::size_t index = 0; index < left_batch.get_batch_size(); index++) {
+            Matrix left_matrix(2, 2), right_matrix(2, 2);
+            for (int i = 0; i < 2; i++) {
+                for (int j = 0; j < 2; j++) {
+                    left_matrix(i, j) = static_cast<int>(index) + i + j;
+                    right_matrix(i, j) = static_cast<int>(index) * (i - j) + 1;
+                }
+            }
+            left_batch.set_matrix(index, left_matrix);
+            right_batch.set_matrix(index, right_matrix);
+        }
+        MatrixBatch product_batch = left_batch * right_batch;
+        std::cout << "Пакетное произведение:\n";
+        for (std::size_t index = 0; index < product_batch.get_batch_size(); index++) {
+            Matrix expected_matrix = left_batch.get_matrix(index) * right_batch.get_matrix(index);
+            Matrix batch_matrix = product_batch.get_matrix(index);
+            bool results_match = true;
+            for (int i = 0; i < 2; i++) {
+                for (int j = 0; j < 2; j++) {
+                    results_match = results_match && expected_matrix(i, j) == batch_matrix(i, j);
+                }
+            }
+            std::cout << batch_matrix << "Совпадает с operator*: " << (results_match ? "да" : "нет") << std::endl;
+        }
     }
     catch (const MatrixNamespace::MatrixException& e) {
         std::cout << "Ошибка матрицы: " << e.what() << std::endl;
@@ -714,6 +1803,34 @@ int main() {
     catch (...) {
         std::cout << "Неизвестное исключение" << std::endl;
     }
+    std::cout << std::endl;
+
+    std::cout << "Задание 5" << std::endl;
+    std::string large_text = "300000 3\n";
+    for (int i = 0; i < 300000; i++) {
+        large_text += (i == 299990 ? "1 2" : std::to_string(i) + " -1 2") + "\n";
+    }
+    const std::string text_inputs[] = {
+        "2 3\n1 2 3\n\n4 5 6\n",
+        "\n2 2\n1 x\n3 4\n",
+        "2 2\n1 2\n3\n",
+        "2 2\n1 2\n\n3 4\n5 6\n",
+        "3 2\n1 2\n\n3 4\n",
+        "20000000 1\n1\n",
+        "1 2000000000\n1\n",
+        large_text,
+    };
+    for (const std::string& text : text_inputs) {
+        try {
+            std::istringstream input(text);
+            Matrix text_matrix = MatrixTextIO::read(input, 4);
+            std::cout << "Прочитана матрица " << text_matrix.get_row_count() << "x" << text_matrix.get_column_count()
+                << ":\n" << text_matrix;
+        }
+        catch (const MatrixNamespace::MatrixException& e) {
+            std::cout << "Ошибка чтения: " << e.what() << std::endl;
+        }
+    }
 
     return 0;
 }